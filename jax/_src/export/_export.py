@@ -1447,6 +1447,7 @@ def _call_exported_lowering(ctx: mlir.LoweringRuleContext, *args,
   submodule = ir.Module.parse(exported.mlir_module())
 
   shardy_enabled = has_sdy_meshes_in_frontend_attrs(submodule)
+  mlir.register_shardy_passes()
   if shardy_enabled:
     with submodule.context:
       # TODO(b/422690222): remove this pass once the bug is fixed.
@@ -507,7 +507,38 @@ def _source_info_to_location(
 
 upstream_dialects = ir.DialectRegistry()
 if register_jax_dialects:
-  register_jax_dialects.register_dialects(upstream_dialects)
+  if hasattr(register_jax_dialects, "register_core_dialects"):
+    register_jax_dialects.register_core_dialects(upstream_dialects)
+  else:
+    register_jax_dialects.register_dialects(upstream_dialects)
+
+_mosaic_gpu_dialects_registered = False
+
+def register_mosaic_gpu_dialects() -> None:
+  """Adds the Mosaic GPU dialects and passes to ``upstream_dialects``.
+
+  Called when ``jax.experimental.mosaic.gpu`` is imported; deferring the
+  registration keeps the GPU dialects out of CPU-only startup. Idempotent.
+  """
+  global _mosaic_gpu_dialects_registered
+  if _mosaic_gpu_dialects_registered:
+    return
+  _mosaic_gpu_dialects_registered = True
+  if register_jax_dialects and hasattr(register_jax_dialects,
+                                       "register_mosaic_gpu"):
+    register_jax_dialects.register_mosaic_gpu(upstream_dialects)
+
+_shardy_passes_registered = False
+
+def register_shardy_passes() -> None:
+  """Registers the Shardy pass pipelines. Idempotent."""
+  global _shardy_passes_registered
+  if _shardy_passes_registered:
+    return
+  _shardy_passes_registered = True
+  if register_jax_dialects and hasattr(register_jax_dialects,
+                                       "register_shardy"):
+    register_jax_dialects.register_shardy()
 
 # Dumping MLIR modules
 _ir_dump_counter = itertools.count()
@@ -1300,6 +1331,7 @@ def lower_jaxpr_to_module(
                      dump_module_message(ctx.module, "verification")) from e
 
   if config.use_shardy_partitioner.value:
+    register_shardy_passes()
     with ctx.context:
       pipeline = passmanager.PassManager.parse(
           'builtin.module(sdy-lift-inlined-meshes)')
@@ -55,6 +55,10 @@ from . import tcgen05
 from . import transform_inference
 from . import utils
 
+# The GPU dialect set is registered lazily so CPU-only users don't pay for
+# it; Mosaic GPU needs it before any kernel is lowered.
+mlir.register_mosaic_gpu_dialects()
+
 # MLIR can't find libdevice unless we point it to the CUDA path
 cuda_root = lib.cuda_path or "/usr/local/cuda"
 os.environ["CUDA_ROOT"] = cuda_root
@@ -59,6 +59,8 @@ XLA_FFI_REGISTER_HANDLER(XLA_FFI_GetApi(), "cu_lu_pivots_to_permutation",
                          "CUDA", LuPivotsToPermutation);
 XLA_FFI_REGISTER_HANDLER(XLA_FFI_GetApi(), "cu_threefry2x32_ffi", "CUDA",
                          ThreeFry2x32Ffi);
+XLA_FFI_REGISTER_HANDLER(XLA_FFI_GetApi(), "cu_philox4x32_ffi", "CUDA",
+                         Philox4x32Ffi);
 
 #if JAX_GPU_HAVE_SPARSE
 XLA_FFI_REGISTER_HANDLER(XLA_FFI_GetApi(), "cusparse_csr_todense_ffi", "CUDA",
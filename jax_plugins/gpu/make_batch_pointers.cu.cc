@@ -16,35 +16,212 @@ limitations under the License.
 #include "jaxlib/gpu/make_batch_pointers.h"
 
 #include <algorithm>
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
 
+#include "jaxlib/gpu/make_batch_pointers_device.h"
 #include "jaxlib/gpu/vendor.h"
 
 namespace jax {
 namespace JAX_GPU_NAMESPACE {
 
 namespace {
+// Each thread writes a pair of pointers with a single 16-byte store so that
+// this bandwidth-bound kernel issues half as many memory transactions.
+// buffer_out is 16-byte aligned: JAX device allocations are 256-byte aligned.
 __global__ void MakeBatchPointersAsyncKernel(char* buffer_in, void** buffer_out,
                                              int64_t batch,
                                              int64_t batch_elem_size) {
-  for (int64_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < batch;
+  const int64_t num_pairs = batch / 2;
+  for (int64_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < num_pairs;
        idx += blockDim.x * gridDim.x) {
-    buffer_out[idx] = buffer_in + idx * batch_elem_size;
+    ulonglong2 v;
+    v.x = reinterpret_cast<unsigned long long>(
+        MakeBatchPtr(buffer_in, 2 * idx, batch_elem_size));
+    v.y = reinterpret_cast<unsigned long long>(
+        MakeBatchPtr(buffer_in, 2 * idx + 1, batch_elem_size));
+    *reinterpret_cast<ulonglong2*>(&buffer_out[2 * idx]) = v;
+  }
+  // Scalar epilogue for an odd trailing element.
+  if (batch % 2 != 0 && blockIdx.x == 0 && threadIdx.x == 0) {
+    buffer_out[batch - 1] = MakeBatchPtr(buffer_in, batch - 1, batch_elem_size);
+  }
+}
+
+// Fused variant: fills the main pointer table and a companion table for an
+// auxiliary per-batch buffer in one launch, with the same pairwise 16-byte
+// stores as above.
+__global__ void MakeBatchPointersWithAuxAsyncKernel(
+    char* buffer_in, void** buffer_out, char* aux_in, void** aux_out,
+    int64_t batch, int64_t batch_elem_size, int64_t aux_elem_size) {
+  const int64_t num_pairs = batch / 2;
+  for (int64_t idx = blockIdx.x * blockDim.x + threadIdx.x; idx < num_pairs;
+       idx += blockDim.x * gridDim.x) {
+    ulonglong2 v;
+    v.x = reinterpret_cast<unsigned long long>(
+        MakeBatchPtr(buffer_in, 2 * idx, batch_elem_size));
+    v.y = reinterpret_cast<unsigned long long>(
+        MakeBatchPtr(buffer_in, 2 * idx + 1, batch_elem_size));
+    *reinterpret_cast<ulonglong2*>(&buffer_out[2 * idx]) = v;
+    ulonglong2 w;
+    w.x = reinterpret_cast<unsigned long long>(
+        MakeBatchPtr(aux_in, 2 * idx, aux_elem_size));
+    w.y = reinterpret_cast<unsigned long long>(
+        MakeBatchPtr(aux_in, 2 * idx + 1, aux_elem_size));
+    *reinterpret_cast<ulonglong2*>(&aux_out[2 * idx]) = w;
+  }
+  // Scalar epilogue for an odd trailing element.
+  if (batch % 2 != 0 && blockIdx.x == 0 && threadIdx.x == 0) {
+    buffer_out[batch - 1] = MakeBatchPtr(buffer_in, batch - 1, batch_elem_size);
+    aux_out[batch - 1] = MakeBatchPtr(aux_in, batch - 1, aux_elem_size);
   }
 }
+
+// Below this batch size, a host-side fill plus a pinned-memory
+// cudaMemcpyAsync is cheaper than a kernel launch.
+constexpr int64_t kHostCopyBatchThreshold = 128;
+
+// Per-thread ring of pinned host memory so small batches can be staged
+// without a gpuMallocHost per call. A slot may still be read by an in-flight
+// gpuMemcpyAsync when the ring wraps, so each slot carries an event recorded
+// after its copy is enqueued and Acquire() waits on it before handing the
+// slot out again. The destructor drains outstanding copies and frees the
+// slab on thread exit.
+class PinnedPtrRing {
+ public:
+  PinnedPtrRing() = default;
+  PinnedPtrRing(const PinnedPtrRing&) = delete;
+  PinnedPtrRing& operator=(const PinnedPtrRing&) = delete;
+
+  ~PinnedPtrRing() {
+    for (gpuEvent_t event : events_) {
+      if (event) {
+        gpuEventSynchronize(event);
+        gpuEventDestroy(event);
+      }
+    }
+    if (slab_) {
+      gpuFreeHost(slab_);
+    }
+  }
+
+  // Returns the next staging slot, or nullptr if pinned memory is
+  // unavailable and the caller should fall back to the kernel path. Blocks
+  // until the previous copy out of the slot (if any) has completed.
+  void** Acquire() {
+    if (slab_ == nullptr) {
+      if (failed_ || gpuMallocHost(reinterpret_cast<void**>(&slab_),
+                                   kNumSlots * kSlotBytes)) {
+        failed_ = true;
+        slab_ = nullptr;
+        return nullptr;
+      }
+    }
+    current_ = (current_ + 1) % kNumSlots;
+    if (events_[current_] != nullptr) {
+      gpuEventSynchronize(events_[current_]);
+    }
+    return reinterpret_cast<void**>(slab_ + current_ * kSlotBytes);
+  }
+
+  // Marks the most recently acquired slot as read by a copy enqueued on
+  // `stream`; Acquire() will not hand the slot out again until that copy has
+  // completed.
+  void MarkInFlight(gpuStream_t stream) {
+    if (events_[current_] == nullptr) {
+      if (auto res = gpuEventCreate(&events_[current_], GPU_EVENT_DEFAULT);
+          res) {
+        events_[current_] = nullptr;
+        // Without an event we cannot track the copy; drain the stream so
+        // the slot is safe to reuse.
+        gpuStreamSynchronize(stream);
+        return;
+      }
+    }
+    if (auto res = gpuEventRecord(events_[current_], stream); res) {
+      // Recording fails when the event was created in a different device
+      // context than the stream's (the ring is per-thread, not per-device).
+      // Drop the event so the next use of this slot recreates it in the
+      // current context, and drain the stream so the slot is safe to reuse.
+      gpuEventDestroy(events_[current_]);
+      events_[current_] = nullptr;
+      gpuStreamSynchronize(stream);
+    }
+  }
+
+ private:
+  static constexpr int kNumSlots = 64;
+  static constexpr std::size_t kSlotBytes =
+      kHostCopyBatchThreshold * sizeof(void*);
+
+  char* slab_ = nullptr;
+  bool failed_ = false;
+  int current_ = -1;
+  gpuEvent_t events_[kNumSlots] = {};
+};
+
+thread_local PinnedPtrRing pinned_ring;
 }  // namespace
 
 void MakeBatchPointersAsync(gpuStream_t stream, void* buffer_in,
                             void* buffer_out, int64_t batch,
                             int64_t batch_elem_size) {
-  const std::size_t block_dim = 128;
+  if (batch < kHostCopyBatchThreshold) {
+    if (void** host_ptrs = pinned_ring.Acquire()) {
+      for (int64_t i = 0; i < batch; ++i) {
+        host_ptrs[i] = static_cast<char*>(buffer_in) + i * batch_elem_size;
+      }
+      gpuMemcpyAsync(buffer_out, host_ptrs, batch * sizeof(void*),
+                     gpuMemcpyHostToDevice, stream);
+      pinned_ring.MarkInFlight(stream);
+      return;
+    }
+  }
+  assert(reinterpret_cast<uintptr_t>(buffer_out) % alignof(ulonglong2) == 0);
+  const std::size_t block_dim = 256;
+  const std::size_t num_pairs = std::max<std::size_t>(1, batch / 2);
   const std::size_t grid_dim =
-      std::min<std::size_t>(1024, (batch + block_dim - 1) / block_dim);
+      std::min<std::size_t>(1024, (num_pairs + block_dim - 1) / block_dim);
   MakeBatchPointersAsyncKernel<<<grid_dim, block_dim, 0, stream>>>(
       static_cast<char*>(buffer_in), static_cast<void**>(buffer_out), batch,
       batch_elem_size);
 }
 
+void MakeBatchPointersAsync(gpuStream_t stream, void* buffer_in,
+                            void* buffer_out, int64_t batch,
+                            int64_t batch_elem_size, void* aux_in,
+                            void* aux_out, int64_t aux_elem_size) {
+  if (batch < kHostCopyBatchThreshold) {
+    if (void** host_ptrs = pinned_ring.Acquire()) {
+      for (int64_t i = 0; i < batch; ++i) {
+        host_ptrs[i] = static_cast<char*>(buffer_in) + i * batch_elem_size;
+      }
+      gpuMemcpyAsync(buffer_out, host_ptrs, batch * sizeof(void*),
+                     gpuMemcpyHostToDevice, stream);
+      pinned_ring.MarkInFlight(stream);
+      // Acquire() cannot fail once the slab exists.
+      void** host_aux_ptrs = pinned_ring.Acquire();
+      for (int64_t i = 0; i < batch; ++i) {
+        host_aux_ptrs[i] = static_cast<char*>(aux_in) + i * aux_elem_size;
+      }
+      gpuMemcpyAsync(aux_out, host_aux_ptrs, batch * sizeof(void*),
+                     gpuMemcpyHostToDevice, stream);
+      pinned_ring.MarkInFlight(stream);
+      return;
+    }
+  }
+  assert(reinterpret_cast<uintptr_t>(buffer_out) % alignof(ulonglong2) == 0);
+  assert(reinterpret_cast<uintptr_t>(aux_out) % alignof(ulonglong2) == 0);
+  const std::size_t block_dim = 256;
+  const std::size_t num_pairs = std::max<std::size_t>(1, batch / 2);
+  const std::size_t grid_dim =
+      std::min<std::size_t>(1024, (num_pairs + block_dim - 1) / block_dim);
+  MakeBatchPointersWithAuxAsyncKernel<<<grid_dim, block_dim, 0, stream>>>(
+      static_cast<char*>(buffer_in), static_cast<void**>(buffer_out),
+      static_cast<char*>(aux_in), static_cast<void**>(aux_out), batch,
+      batch_elem_size, aux_elem_size);
+}
+
 }  // namespace JAX_GPU_NAMESPACE
 }  // namespace jax
@@ -23,10 +23,22 @@ limitations under the License.
 namespace jax {
 namespace JAX_GPU_NAMESPACE {
 
+// Materializes an array of batch pointers in device memory. This is a
+// fallback for batched cuBLAS/cuSOLVER APIs that require a device pointer
+// array; kernels we launch ourselves should compute pointers on the fly with
+// MakeBatchPtr from make_batch_pointers_device.h instead of persisting them.
 void MakeBatchPointersAsync(gpuStream_t stream, void* buffer_in,
                             void* buffer_out, int64_t batch,
                             int64_t batch_elem_size);
 
+// Fused variant that also fills a companion pointer table for an auxiliary
+// per-batch buffer (e.g. the tau vectors of batched QR) in the same launch,
+// saving a kernel launch over two back-to-back MakeBatchPointersAsync calls.
+void MakeBatchPointersAsync(gpuStream_t stream, void* buffer_in,
+                            void* buffer_out, int64_t batch,
+                            int64_t batch_elem_size, void* aux_in,
+                            void* aux_out, int64_t aux_elem_size);
+
 }  // namespace JAX_GPU_NAMESPACE
 }  // namespace jax
 
@@ -0,0 +1,40 @@
+/* Copyright 2024 The JAX Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef JAXLIB_GPU_MAKE_BATCH_POINTERS_DEVICE_H_
+#define JAXLIB_GPU_MAKE_BATCH_POINTERS_DEVICE_H_
+
+#include <cstdint>
+
+#include "jaxlib/gpu/vendor.h"
+
+namespace jax {
+namespace JAX_GPU_NAMESPACE {
+
+// Computes the address of the i-th batch element on the fly. Kernels that
+// consume per-batch pointers directly should call this instead of reading a
+// pointer array materialized by MakeBatchPointersAsync; that avoids an extra
+// kernel launch and a global-memory round-trip of batch * sizeof(void*)
+// bytes. The materialized array is only needed for batched cuBLAS/cuSOLVER
+// APIs, which take a device pointer array by contract.
+__device__ __forceinline__ void* MakeBatchPtr(void* base, int64_t i,
+                                              int64_t stride) {
+  return static_cast<char*>(base) + i * stride;
+}
+
+}  // namespace JAX_GPU_NAMESPACE
+}  // namespace jax
+
+#endif  // JAXLIB_GPU_MAKE_BATCH_POINTERS_DEVICE_H_
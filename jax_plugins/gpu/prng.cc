@@ -25,10 +25,20 @@ namespace {
 namespace nb = nanobind;
 
 nb::dict Registrations() {
-  nb::dict dict;
-  dict[JAX_GPU_PREFIX "_threefry2x32_ffi"] =
-      EncapsulateFfiHandler(ThreeFry2x32Ffi);
-  return dict;
+  // The registrations are immutable, so build the dict once and return the
+  // same object on later calls. Deliberately leaked: tearing it down at
+  // interpreter shutdown is not safe without the GIL.
+  static nb::dict* const dict = []() {
+    auto* d = new nb::dict();
+    (*d)[JAX_GPU_PREFIX "_threefry2x32_ffi"] =
+        EncapsulateFfiHandler(ThreeFry2x32Ffi);
+    // Opt-in alternative to Threefry: fewer rounds and higher arithmetic
+    // intensity per memory transaction, at the cost of a different stream.
+    (*d)[JAX_GPU_PREFIX "_philox4x32_ffi"] =
+        EncapsulateFfiHandler(Philox4x32Ffi);
+    return d;
+  }();
+  return *dict;
 }
 
 NB_MODULE(_prng, m) {
@@ -46,6 +46,22 @@ ffi::Error ThreeFry2x32Impl(gpuStream_t stream,
   FFI_RETURN_IF_ERROR_STATUS(JAX_AS_STATUS(gpuGetLastError()));
   return ffi::Error::Success();
 }
+
+ffi::Error Philox4x32Impl(gpuStream_t stream,
+                          ffi::Buffer<ffi::DataType::U32> keys,
+                          ffi::Buffer<ffi::DataType::U32> counters,
+                          ffi::Result<ffi::Buffer<ffi::DataType::U32>> out) {
+  std::int64_t size =
+      absl::c_accumulate(out->dimensions(), 1, std::multiplies<int64_t>());
+  if (size % 4 != 0) {
+    return ffi::Error::InvalidArgument(
+        "The output of philox4x32 must have a size divisible by 4");
+  }
+  LaunchPhilox4x32KernelFfi(stream, size / 4, keys.typed_data(),
+                            counters.typed_data(), out->typed_data());
+  FFI_RETURN_IF_ERROR_STATUS(JAX_AS_STATUS(gpuGetLastError()));
+  return ffi::Error::Success();
+}
 }  // namespace
 
 XLA_FFI_DEFINE_HANDLER_SYMBOL(ThreeFry2x32Ffi, ThreeFry2x32Impl,
@@ -58,5 +74,12 @@ XLA_FFI_DEFINE_HANDLER_SYMBOL(ThreeFry2x32Ffi, ThreeFry2x32Impl,
                                   .Ret<ffi::Buffer<ffi::DataType::U32>>()
                                   .Ret<ffi::Buffer<ffi::DataType::U32>>());
 
+XLA_FFI_DEFINE_HANDLER_SYMBOL(Philox4x32Ffi, Philox4x32Impl,
+                              ffi::Ffi::Bind()
+                                  .Ctx<ffi::PlatformStream<gpuStream_t>>()
+                                  .Arg<ffi::Buffer<ffi::DataType::U32>>()
+                                  .Arg<ffi::Buffer<ffi::DataType::U32>>()
+                                  .Ret<ffi::Buffer<ffi::DataType::U32>>());
+
 }  // namespace JAX_GPU_NAMESPACE
 }  // namespace jax
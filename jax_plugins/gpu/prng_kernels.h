@@ -30,7 +30,16 @@ void LaunchThreeFry2x32KernelFfi(gpuStream_t stream,
                                  std::uint32_t *data0, std::uint32_t *data1,
                                  std::uint32_t *out0, std::uint32_t *out1);
 
+// Generates `n` blocks of four random uint32s with Philox4x32-10. `keys` holds
+// `n` interleaved key pairs, `counters` holds `n` interleaved 4x32 counters,
+// and `out` receives `n` interleaved 4x32 blocks.
+void LaunchPhilox4x32KernelFfi(gpuStream_t stream, std::int64_t n,
+                               const std::uint32_t *keys,
+                               const std::uint32_t *counters,
+                               std::uint32_t *out);
+
 XLA_FFI_DECLARE_HANDLER_SYMBOL(ThreeFry2x32Ffi);
+XLA_FFI_DECLARE_HANDLER_SYMBOL(Philox4x32Ffi);
 
 }  // namespace JAX_GPU_NAMESPACE
 }  // namespace jax
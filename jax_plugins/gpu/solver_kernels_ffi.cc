@@ -267,9 +267,7 @@ ffi::Error GeqrfBatchedImpl(int64_t batch, int64_t rows, int64_t cols,
   }
 
   MakeBatchPointersAsync(stream, out_data, out_batch_ptrs, batch,
-                         sizeof(T) * m * n);
-  JAX_FFI_RETURN_IF_GPU_ERROR(gpuGetLastError());
-  MakeBatchPointersAsync(stream, tau_data, tau_batch_ptrs, batch,
+                         sizeof(T) * m * n, tau_data, tau_batch_ptrs,
                          sizeof(T) * std::min(m, n));
   JAX_FFI_RETURN_IF_GPU_ERROR(gpuGetLastError());
 
@@ -15,9 +15,14 @@ limitations under the License.
 
 #include <cstdint>
 #include <string>
+#include <utility>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/node_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 #include "third_party/gpus/cuda/include/cuda.h"
 #include "nanobind/nanobind.h"
 #include "jaxlib/gpu/gpu_plugin_extension.h"
@@ -30,20 +35,35 @@ namespace nb = nanobind;
 namespace xla {
 namespace {
 
-static std::string ToString(CUresult result) {
-  const char* error_name;
-  if (cuGetErrorName(result, &error_name)) {
-    return absl::StrCat("UNKNOWN ERROR (", static_cast<int>(result), ")");
+static const std::string& ToString(CUresult result) {
+  // cuGetErrorName/cuGetErrorString take a driver-wide lock and the StrCat
+  // below allocates, so format each error code once and hand out a reference
+  // to the cached message. node_hash_map guarantees reference stability
+  // across rehashes, and entries are never erased.
+  static absl::Mutex mu(absl::kConstInit);
+  static auto* cache ABSL_GUARDED_BY(mu) =
+      new absl::node_hash_map<CUresult, std::string>();
+  absl::MutexLock lock(&mu);
+  auto it = cache->find(result);
+  if (it == cache->end()) {
+    const char* error_name;
+    const char* error_string;
+    std::string message;
+    if (cuGetErrorName(result, &error_name)) {
+      message = absl::StrCat("UNKNOWN ERROR (", static_cast<int>(result), ")");
+    } else if (cuGetErrorString(result, &error_string)) {
+      message = error_name;
+    } else {
+      message = absl::StrCat(error_name, ": ", error_string);
+    }
+    it = cache->emplace(result, std::move(message)).first;
   }
-  const char* error_string;
-  if (cuGetErrorString(result, &error_string)) {
-    return error_name;
-  }
-  return absl::StrCat(error_name, ": ", error_string);
+  return it->second;
 }
 
-nb::dict FfiRegistrations() {
-  nb::dict dict;
+nb::dict BuildFfiRegistrations() {
+  // Presize for the four top-level entries to avoid CPython dict resizes.
+  nb::dict dict = nb::steal<nb::dict>(_PyDict_NewPresized(4));
   nb::dict gpu_callback_dict;
   gpu_callback_dict["instantiate"] =
       jax::EncapsulateFfiHandler(jax::cuda::kGpuTransposePlanCacheInstantiate);
@@ -59,6 +79,14 @@ nb::dict FfiRegistrations() {
   return dict;
 }
 
+nb::dict FfiRegistrations() {
+  // The registrations are immutable, so build the dict once and return the
+  // same object on later calls. Deliberately leaked: tearing it down at
+  // interpreter shutdown is not safe without the GIL.
+  static nb::dict* const dict = new nb::dict(BuildFfiRegistrations());
+  return *dict;
+}
+
 }  // namespace
 
 NB_MODULE(cuda_plugin_extension, m) {
@@ -71,12 +99,32 @@ NB_MODULE(cuda_plugin_extension, m) {
         if (data_value == 0) {
           return 0;
         }
+        // A page belongs to a single device, so cache ordinals per page;
+        // DLPack-heavy interop asks about the same pointers repeatedly.
+        thread_local absl::flat_hash_map<std::uintptr_t, int> ordinal_cache;
+        const std::uintptr_t page =
+            static_cast<std::uintptr_t>(data_value) >> 12;
+        if (auto it = ordinal_cache.find(page); it != ordinal_cache.end()) {
+          return it->second;
+        }
         int device_ordinal;
         void* data_ptr = reinterpret_cast<void*>(data_value);
-        CUresult result =
-            cuPointerGetAttribute(static_cast<void*>(&device_ordinal),
-                                  CU_POINTER_ATTRIBUTE_DEVICE_ORDINAL,
-                                  reinterpret_cast<CUdeviceptr>(data_ptr));
+        CUresult result;
+        {
+          // The driver call does not need the GIL; let other Python threads
+          // run while we are in libcuda.
+          nb::gil_scoped_release release;
+          result =
+              cuPointerGetAttribute(static_cast<void*>(&device_ordinal),
+                                    CU_POINTER_ATTRIBUTE_DEVICE_ORDINAL,
+                                    reinterpret_cast<CUdeviceptr>(data_ptr));
+        }
+        if (result == CUDA_SUCCESS) {
+          if (ordinal_cache.size() >= 64) {
+            ordinal_cache.clear();
+          }
+          ordinal_cache[page] = device_ordinal;
+        }
         if (result != CUDA_SUCCESS) {
           xla::ThrowIfError(absl::InvalidArgumentError(absl::StrCat(
               "Not able to get the device_ordinal: ", ToString(result))));
@@ -37,32 +37,60 @@ limitations under the License.
 
 namespace nb = nanobind;
 
-#define REGISTER_DIALECT(name)                                           \
-  MlirDialectHandle name##_dialect = mlirGetDialectHandle__##name##__(); \
-  mlirDialectHandleInsertDialect(name##_dialect, registry)
+namespace {
+
+void RegisterCoreDialects(MlirDialectRegistry registry) {
+  // Collect all handles first and insert them in a single pass over the
+  // registry rather than interleaving handle lookups with insertions.
+  // cf and gpu are needed outside Mosaic GPU as well: Pallas TPU lowering
+  // emits cf.assert_ and Pallas Triton emits gpu.barrier, both into contexts
+  // built from the core registry.
+  const MlirDialectHandle dialects[] = {
+      mlirGetDialectHandle__arith__(),  mlirGetDialectHandle__func__(),
+      mlirGetDialectHandle__math__(),   mlirGetDialectHandle__memref__(),
+      mlirGetDialectHandle__scf__(),    mlirGetDialectHandle__vector__(),
+      mlirGetDialectHandle__cf__(),     mlirGetDialectHandle__gpu__(),
+  };
+  for (MlirDialectHandle dialect : dialects) {
+    mlirDialectHandleInsertDialect(dialect, registry);
+  }
+  // Transforms used by JAX.
+  mlirRegisterTransformsPasses();
+  mlirRegisterTransformsStripDebugInfo();
+}
+
+void RegisterMosaicGpu(MlirDialectRegistry registry) {
+  const MlirDialectHandle dialects[] = {
+      mlirGetDialectHandle__nvgpu__(), mlirGetDialectHandle__nvvm__(),
+      mlirGetDialectHandle__llvm__(),
+  };
+  for (MlirDialectHandle dialect : dialects) {
+    mlirDialectHandleInsertDialect(dialect, registry);
+  }
+  mlirMosaicGpuRegisterPasses();
+}
+
+void RegisterShardy() {
+  mlirRegisterAllSdyPassesAndPipelines();
+  mlirRegisterAllXlaSdyPassesAndPipelines();
+}
+
+}  // namespace
 
 NB_MODULE(register_jax_dialects, m) {
   m.doc() = "Registers upstream MLIR dialects used by JAX.";
 
+  // Always needed; called by mlir/__init__.py during initialization.
+  m.def("register_core_dialects", &RegisterCoreDialects);
+  // Deferred until the corresponding subsystem is imported so CPU-only
+  // workloads don't pay for them at startup.
+  m.def("register_mosaic_gpu", &RegisterMosaicGpu);
+  m.def("register_shardy", &RegisterShardy);
+
+  // Registers everything eagerly, for callers of the original entry point.
   m.def("register_dialects", [](MlirDialectRegistry registry) {
-    REGISTER_DIALECT(arith);
-    REGISTER_DIALECT(func);
-    REGISTER_DIALECT(math);
-    REGISTER_DIALECT(memref);
-    REGISTER_DIALECT(scf);
-    REGISTER_DIALECT(vector);
-    // For Mosaic GPU
-    REGISTER_DIALECT(cf);
-    REGISTER_DIALECT(gpu);
-    REGISTER_DIALECT(nvgpu);
-    REGISTER_DIALECT(nvvm);
-    REGISTER_DIALECT(llvm);
-    mlirMosaicGpuRegisterPasses();
-    mlirRegisterTransformsPasses();
-    // For Shardy
-    mlirRegisterAllSdyPassesAndPipelines();
-    mlirRegisterAllXlaSdyPassesAndPipelines();
-    // Transforms used by JAX.
-    mlirRegisterTransformsStripDebugInfo();
+    RegisterCoreDialects(registry);
+    RegisterMosaicGpu(registry);
+    RegisterShardy();
   });
 }
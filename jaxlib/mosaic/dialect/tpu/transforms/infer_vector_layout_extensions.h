@@ -21,13 +21,19 @@ limitations under the License.
 
 #include "mlir/IR/Operation.h"
 #include "mlir/Support/LLVM.h"
+#include "mlir/Support/LogicalResult.h"
 
 namespace mlir::tpu::extensions {
 
-bool canInferVectorLayout(const Operation &op);
+// These extension hooks have no open-source implementation. Defining them
+// inline lets the compiler fold the canInferVectorLayout check away and
+// dead-code-eliminate its branch in the per-op inference loop.
+inline bool canInferVectorLayout(const Operation &op) { return false; }
 
-LogicalResult inferVectorLayout(const Operation &op,
-                                std::array<int64_t, 2> target_shape);
+inline LogicalResult inferVectorLayout(const Operation &op,
+                                       std::array<int64_t, 2> target_shape) {
+  return failure();
+}
 
 }  // namespace mlir::tpu::extensions
 
@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "jaxlib/py_host_callback.h"
 
+#include <Python.h>
+
 #include <cstdint>
 #include <exception>
 #include <memory>
@@ -118,14 +120,6 @@ absl::StatusOr<std::vector<CpuCallback::Result>> CreateCallbackResults(
 
 }  // namespace
 
-PyFfiLoadedHostCallback::~PyFfiLoadedHostCallback() {
-  // The destructor may be called without GIL held. In that case, we defer it
-  // to GlobalPyRefManager.
-  std::vector<nb::object> objects;
-  objects.push_back(std::move(callable_));
-  GlobalPyRefManager()->AddGarbage(absl::MakeSpan(objects));
-}
-
 absl::StatusOr<tsl::RCReference<PyHostSendAndRecvLoadedHostCallback>>
 PyHostSendAndRecvLoadedHostCallback::Create(
     ifrt::Client* ifrt_client, nb::callable callable,
@@ -193,6 +187,11 @@ PyHostSendAndRecvLoadedHostCallback::PyHostSendAndRecvLoadedHostCallback(
       serializer_(serializer) {}
 
 PyHostSendAndRecvLoadedHostCallback::~PyHostSendAndRecvLoadedHostCallback() {
+  if (PyGILState_Check()) {
+    callable_ = nb::callable();
+    serializer_ = nb::callable();
+    return;
+  }
   GlobalPyRefManager()->AddGarbage(
       absl::MakeSpan(static_cast<nb::object*>(&callable_), 1));
   GlobalPyRefManager()->AddGarbage(
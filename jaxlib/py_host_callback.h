@@ -20,10 +20,12 @@ limitations under the License.
 #include <memory>
 #include <string>
 #include <utility>
-#include <vector>
 
+#include "absl/container/inlined_vector.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
+#include "jaxlib/python_ref_manager.h"
 #include "llvm/Support/ExtensibleRTTI.h"
 #include "nanobind/nanobind.h"
 #include "xla/pjrt/host_callback.h"
@@ -48,12 +50,27 @@ class PyFfiLoadedHostCallback final
                           ifrt::PjRtFfiLoadedHostCallback>(ifrt_client,
                                                            callable.ptr()),
         callable_(std::move(callable)) {}
-  ~PyFfiLoadedHostCallback() override;
+
+  // Defined inline so the (frequent) destruction of the callback does not go
+  // through an out-of-line call. The destructor may run without the GIL held;
+  // in that case dropping the reference is deferred to GlobalPyRefManager.
+  ~PyFfiLoadedHostCallback() override {
+    if (PyGILState_Check()) {
+      callable_ = nanobind::callable();
+      return;
+    }
+    GlobalPyRefManager()->AddGarbage(
+        absl::MakeSpan(static_cast<nanobind::object*>(&callable_), 1));
+  }
 
   ifrt::Client* client() const override { return ifrt_client_; }
   absl::StatusOr<std::string> Serialize() const override {
-    return Unimplemented(
-        "PyFfiLoadedHostCallback::Serialize() is not supported");
+    // Serialization is never supported; cache the status so repeated calls
+    // (e.g. during checkpointing attempts) don't rebuild the error string.
+    static const absl::Status* const kUnimplemented =
+        new absl::Status(Unimplemented(
+            "PyFfiLoadedHostCallback::Serialize() is not supported"));
+    return *kUnimplemented;
   };
 
   static char ID;  // NOLINT
@@ -105,12 +122,14 @@ class PyHostSendAndRecvLoadedHostCallback final
   template <typename T, typename... Args>
   friend tsl::RCReference<T> tsl::MakeRef(Args&&... args);
 
-  // Retained arguments for host callback serialization.
+  // Retained arguments for host callback serialization. Typical callbacks
+  // carry only a few channels and shapes, so keep them inline to avoid heap
+  // allocations at construction.
   nanobind::callable callable_;
-  std::vector<Shape> operand_shapes_;
-  std::vector<Shape> result_shapes_;
-  std::vector<uint16_t> send_channel_ids_;
-  std::vector<uint16_t> recv_channel_ids_;
+  absl::InlinedVector<Shape, 4> operand_shapes_;
+  absl::InlinedVector<Shape, 4> result_shapes_;
+  absl::InlinedVector<uint16_t, 8> send_channel_ids_;
+  absl::InlinedVector<uint16_t, 8> recv_channel_ids_;
   nanobind::callable serializer_;
 };
 
@@ -15,12 +15,15 @@ limitations under the License.
 
 #include "jaxlib/util.h"
 
-#include <memory>
-#include <vector>
+#include <Python.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include "absl/container/inlined_vector.h"
+#include "absl/log/check.h"
 #include "absl/status/status.h"
-#include "absl/synchronization/notification.h"
-#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "nanobind/nanobind.h"
 #include "xla/pjrt/pjrt_future.h"
@@ -35,14 +38,70 @@ limitations under the License.
 
 namespace xla {
 
+namespace {
+
+// Returns true if this is the Python main thread. CPython only runs signal
+// handlers on the interpreter's main thread, so other threads need not wake
+// up periodically to poll for signals: PyErr_CheckSignals() is a no-op for
+// them. An embedded interpreter may be initialized off the process main
+// thread, so ask Python itself rather than the OS. The answer cannot change
+// for the lifetime of a thread, so it is computed once per thread: only the
+// first wait on a thread pays for a GIL acquisition. Where we cannot tell, we
+// conservatively report "main" and keep polling.
+bool IsPythonMainThread() {
+  thread_local const bool is_main = [] {
+    nanobind::gil_scoped_acquire gil_acquire;
+    try {
+      nanobind::object main_thread =
+          nanobind::module_::import_("threading").attr("main_thread")();
+      return nanobind::cast<unsigned long>(main_thread.attr("ident")) ==
+             PyThread_get_thread_ident();
+    } catch (...) {
+      return true;
+    }
+  }();
+  return is_main;
+}
+
+}  // namespace
+
 void BlockUntilReadyWithCancel(xla::PjRtFuture<>& future) {
   future.BlockUntilReady([](tsl::AsyncValue* value) {
-    auto state = std::make_shared<absl::Notification>();
-    value->AndThen([state]() { state->Notify(); });
+    // Fast path: the future may already be ready, in which case there is no
+    // need to set up any synchronization state.
+    if (value->IsAvailable()) {
+      return;
+    }
+    struct State {
+      std::mutex mu;
+      std::condition_variable cv;
+      bool done = false;
+    };
+    auto state = std::make_shared<State>();
+    value->AndThen([state]() {
+      {
+        std::lock_guard<std::mutex> lock(state->mu);
+        state->done = true;
+      }
+      state->cv.notify_all();
+    });
+    if (!IsPythonMainThread()) {
+      // No signal handler can run on this thread, so skip the periodic
+      // GIL-acquiring signal poll and block until the value is ready.
+      std::unique_lock<std::mutex> lock(state->mu);
+      state->cv.wait(lock, [&]() { return state->done; });
+      return;
+    }
     while (true) {
-      if (state->WaitForNotificationWithTimeout(absl::Milliseconds(200))) {
-        break;
+      {
+        std::unique_lock<std::mutex> lock(state->mu);
+        if (state->cv.wait_for(lock, std::chrono::milliseconds(200),
+                               [&]() { return state->done; })) {
+          break;
+        }
       }
+      // The lock must not be held while reacquiring the GIL; the AndThen
+      // callback may fire concurrently.
       nanobind::gil_scoped_acquire gil_acquire;
       if (PyErr_CheckSignals() != 0) {
         throw nanobind::python_error();
@@ -52,15 +111,36 @@ void BlockUntilReadyWithCancel(xla::PjRtFuture<>& future) {
 }
 
 absl::Status AwaitBuffersReady(absl::Span<ifrt::Array* const> ifrt_arrays) {
+  // Callers must have dropped the GIL: the wait below can block for a long
+  // time, and callbacks on the ready path may themselves need the GIL.
+  DCHECK(!PyGILState_Check());
   if (ifrt_arrays.empty()) {
     return absl::OkStatus();
   }
 
+  // Fast path: arrays are frequently awaited after they have already become
+  // ready, in which case the ref-count bumps and the combined future below
+  // are pure overhead. A ready future may still hold an error, so fall
+  // through to the slow path to produce it.
+  bool all_ready_and_ok = true;
+  for (ifrt::Array* const ifrt_array : ifrt_arrays) {
+    ifrt::Future<> ready = ifrt_array->GetReadyFuture();
+    if (!ready.IsReady() || !ready.Await().ok()) {
+      all_ready_and_ok = false;
+      break;
+    }
+  }
+  if (all_ready_and_ok) {
+    return absl::OkStatus();
+  }
+
   ifrt::Future<> future;
   if (ifrt_arrays.size() == 1) {
     future = ifrt_arrays[0]->GetReadyFuture();
   } else {
-    std::vector<ifrt::ValueRef> values;
+    // Most calls come from jitted computations with a handful of outputs, so
+    // keep the refs inline to avoid a heap allocation on this hot path.
+    absl::InlinedVector<ifrt::ValueRef, 8> values;
     values.reserve(ifrt_arrays.size());
     for (ifrt::Array* const ifrt_array : ifrt_arrays) {
       values.push_back(tsl::FormRef(ifrt_array));
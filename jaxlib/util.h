@@ -26,7 +26,9 @@ namespace xla {
 void BlockUntilReadyWithCancel(xla::PjRtFuture<>& future);
 
 // Requests if given buffers are ready, awaits for results and returns OK if
-// all of the buffers are ready or the last non-ok status.
+// all of the buffers are ready or the last non-ok status. Must be called
+// without the GIL held so other Python threads can run during the wait; the
+// GIL is only reacquired briefly to check for signal delivery.
 absl::Status AwaitBuffersReady(absl::Span<ifrt::Array* const> ifrt_arrays);
 
 }  // namespace xla
@@ -323,6 +323,85 @@ def ffi_call_geqrf(x, _use_extend=False, **kwargs):
       cuda=partial(call, "cuda"))
 
 
+class PhiloxFfiTest(jtu.JaxTestCase):
+
+  @jtu.sample_product(num_blocks=[1, 2, 128, 1025])
+  @jtu.run_on_devices("gpu")
+  def test_matches_reference(self, num_blocks):
+    rng = self.rng()
+    keys = rng.randint(0, 2**32, size=(num_blocks, 2), dtype=np.uint32)
+    counters = rng.randint(0, 2**32, size=(num_blocks, 4), dtype=np.uint32)
+    actual = ffi_call_philox4x32(keys, counters)
+    self.assertArraysEqual(actual, philox4x32_reference(keys, counters))
+
+  @jtu.run_on_devices("gpu")
+  def test_known_answer_vectors(self):
+    # Philox4x32-10 vectors from the Random123 test suite (Salmon et al.,
+    # "Parallel Random Numbers: As Easy as 1, 2, 3"). These also pin down the
+    # NumPy reference used by test_matches_reference.
+    keys = np.array([
+        [0x00000000, 0x00000000],
+        [0xffffffff, 0xffffffff],
+        [0xa4093822, 0x299f31d0],
+    ], dtype=np.uint32)
+    counters = np.array([
+        [0x00000000, 0x00000000, 0x00000000, 0x00000000],
+        [0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff],
+        [0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344],
+    ], dtype=np.uint32)
+    expected = np.array([
+        [0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8],
+        [0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd],
+        [0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1],
+    ], dtype=np.uint32)
+    self.assertArraysEqual(philox4x32_reference(keys, counters), expected)
+    self.assertArraysEqual(ffi_call_philox4x32(keys, counters), expected)
+
+  @jtu.run_on_devices("gpu")
+  def test_odd_output_size_rejected(self):
+    keys = np.zeros((1, 2), dtype=np.uint32)
+    counters = np.zeros((3,), dtype=np.uint32)
+    with self.assertRaisesRegex(Exception, "must have a size divisible by 4"):
+      jax.block_until_ready(ffi_call_philox4x32(keys, counters))
+
+
+def philox4x32_reference(keys, counters):
+  """NumPy Philox4x32-10 over trailing [2] key and [4] counter axes."""
+  m4x32a = np.uint64(0xD2511F53)
+  m4x32b = np.uint64(0xCD9E8D57)
+  w32a = np.uint32(0x9E3779B9)
+  w32b = np.uint32(0xBB67AE85)
+  k0 = keys[..., 0].copy()
+  k1 = keys[..., 1].copy()
+  x = np.asarray(counters)
+  for _ in range(10):
+    prod0 = m4x32a * x[..., 0].astype(np.uint64)
+    prod1 = m4x32b * x[..., 2].astype(np.uint64)
+    hi0 = (prod0 >> np.uint64(32)).astype(np.uint32)
+    lo0 = prod0.astype(np.uint32)
+    hi1 = (prod1 >> np.uint64(32)).astype(np.uint32)
+    lo1 = prod1.astype(np.uint32)
+    x = np.stack([hi1 ^ x[..., 1] ^ k0, lo1, hi0 ^ x[..., 3] ^ k1, lo0],
+                 axis=-1)
+    k0 = k0 + w32a
+    k1 = k1 + w32b
+  return x
+
+
+def ffi_call_philox4x32(keys, counters):
+  out_type = jax.ShapeDtypeStruct(np.shape(counters), np.uint32)
+
+  def call(platform, keys, counters):
+    target_name = dict(
+        rocm="hip_philox4x32_ffi",
+        cuda="cu_philox4x32_ffi",
+    )[platform]
+    return jax.ffi.ffi_call(target_name, out_type)(keys, counters)
+
+  return lax.platform_dependent(
+      keys, counters, rocm=partial(call, "rocm"), cuda=partial(call, "cuda"))
+
+
 class BatchPartitioningTest(jtu.JaxTestCase):
   def setUp(self):
     super().setUp()